@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "World.h"
+#include "Search.h"
+#include "ParallelSearch.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(Clock::time_point began) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - began).count();
+}
+
+// Adds up the cost of a path, or returns -1 if it steps through walls or jumps between tiles
+template <int Connectivity, typename Cost>
+static double pathCost(const World& world, const std::vector<Tile>& path) {
+	double cost = 0.0;
+	for (std::size_t i = 1; i < path.size(); i++) {
+		int dRow = std::abs(world.rowOf(path[i]) - world.rowOf(path[i - 1]));
+		int dCol = std::abs(world.colOf(path[i]) - world.colOf(path[i - 1]));
+		bool diagonal = dRow == 1 && dCol == 1;
+		if (world.isBlocked(path[i]) || dRow > 1 || dCol > 1 || dRow + dCol == 0 || (diagonal && Connectivity == 4)) { return -1.0; }
+		cost += static_cast<double>(diagonal ? Cost::diagonal : Cost::straight);
+	}
+	return cost;
+}
+
+template <int Connectivity, typename Cost>
+static int benchmark(const World& world, Tile start, Tile end, int maxThreads) {
+	NullObserver observer;
+	Clock::time_point began = Clock::now();
+	SearchResult<Cost> sequential = aStarSearch<Connectivity, Cost>(world, start, end, observer);
+	double sequentialMs = millisecondsSince(began);
+
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "sequential A*: " << sequentialMs << " ms, " << sequential.expanded << " tiles expanded" << std::endl;
+	if (!sequential.found) {
+		std::cout << "No path between the corners of this map" << std::endl;
+		return 1;
+	}
+	double bestCost = pathCost<Connectivity, Cost>(world, sequential.path);
+
+	// Thread counts double up to maxThreads, always ending on maxThreads itself
+	int failures = 0;
+	std::cout << "threads      ms   speedup   expanded" << std::endl;
+	for (int threads = 1; threads <= maxThreads; threads = (threads == maxThreads) ? threads + 1 : std::min(threads * 2, maxThreads)) {
+		began = Clock::now();
+		SearchResult<Cost> parallel = parallelAStarSearch<Connectivity, Cost>(world, start, end, threads);
+		double parallelMs = millisecondsSince(began);
+
+		double cost = pathCost<Connectivity, Cost>(world, parallel.path);
+		bool optimal = parallel.found && parallel.path.front() == start && parallel.path.back() == end && std::abs(cost - bestCost) <= 1e-6 * bestCost;
+		failures += optimal ? 0 : 1;
+
+		std::cout << std::setw(7) << threads << std::setw(8) << parallelMs << std::setw(9) << sequentialMs / parallelMs << "x"
+			<< std::setw(11) << parallel.expanded << (optimal ? "" : "   path is not optimal") << std::endl;
+	}
+	return failures == 0 ? 0 : 1;
+}
+
+int runBenchmark(int rows, int cols, bool diagonal, bool floatCosts, int maxThreads) {
+	// A fixed seed keeps the map the same between runs. Walls are scattered at random,
+	// plus long barriers with a single gap that force the search to flood most of the map
+	World world(rows, cols);
+	std::mt19937 rng(1);
+	std::bernoulli_distribution wall(0.25);
+	for (int row = 0; row < rows; row++) {
+		for (int col = 0; col < cols; col++) {
+			if (wall(rng)) { world.setBlocked(row, col, true); }
+		}
+	}
+	// Barriers need room between them, so short maps go without
+	const int minBarrierRows = 16;
+	int barrierCount = rows >= minBarrierRows ? 3 : 0;
+	for (int barrier = 1; barrier <= barrierCount; barrier++) {
+		int row = rows * barrier / 4;
+		int gapStart = (barrier % 2 == 1) ? std::max(cols - 8, 0) : 0;
+		int gapEnd = std::min(gapStart + 8, cols);
+		for (int col = 0; col < cols; col++) {
+			bool inGap = col >= gapStart && col < gapEnd;
+			world.setBlocked(row, col, !inGap);
+			world.setBlocked(row + 1, col, !inGap);
+		}
+	}
+
+	// Random walls can still seal a gap or wall in a corner, so carve one route between the corners:
+	// along a row, then down the edge column holding the next barrier's gap, alternating sides
+	Tile start = world.tileAt(0, 0);
+	Tile end = world.tileAt(rows - 1, cols - 1);
+	int routeRow = 0;
+	for (int barrier = 1; barrier <= barrierCount + 1; barrier++) {
+		for (int col = 0; col < cols; col++) {
+			world.setBlocked(routeRow, col, false);
+		}
+		int sideCol = (barrier % 2 == 1 || barrier > barrierCount) ? cols - 1 : 0;
+		int nextRow = (barrier <= barrierCount) ? rows * barrier / 4 + 2 : rows - 1;
+		for (int row = routeRow; row <= nextRow; row++) {
+			world.setBlocked(row, sideCol, false);
+		}
+		routeRow = nextRow;
+	}
+
+	std::cout << rows << " x " << cols << " tiles, " << (diagonal ? "8" : "4") << "-connected, "
+		<< (floatCosts ? "float" : "integer") << " costs" << std::endl;
+	if (diagonal) {
+		return floatCosts ? benchmark<8, FloatCost>(world, start, end, maxThreads) : benchmark<8, FixedCost>(world, start, end, maxThreads);
+	}
+	return floatCosts ? benchmark<4, FloatCost>(world, start, end, maxThreads) : benchmark<4, FixedCost>(world, start, end, maxThreads);
+}
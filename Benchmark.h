@@ -0,0 +1,6 @@
+#pragma once
+
+// Times sequential A* and parallel (HDA*) A* on a random map without opening a window,
+// printing the speedup for each thread count from 1 up to maxThreads.
+// Returns 0 if every parallel search found a path as short as the sequential one
+int runBenchmark(int rows, int cols, bool diagonal, bool floatCosts, int maxThreads);
@@ -0,0 +1,358 @@
+#pragma once
+
+#include "Search.h"
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+
+// Hash distributed A* (HDA*) for a single query on large grids.
+// Every tile is owned by one worker thread, picked by hashing the small block of tiles it sits in.
+// Each worker keeps the open list and g scores for its own tiles only, and neighbors owned by
+// another worker are sent to it in batches through a lock-free inbox. Since workers do not expand
+// in global fScore order, a tile can be reopened when a cheaper route to it arrives later.
+// see Kishimoto, Fukunaga and Botea, "Evaluation of a simple, scalable, parallel best-first search strategy"
+template <int Connectivity, typename Cost, typename Grid>
+class ParallelAStar {
+public:
+	static constexpr std::size_t BATCHSIZE = 64;  // Messages per batch sent to another worker
+	static constexpr int FLUSHEVERY = 32;         // Expansions between sending partially filled batches
+	static constexpr int BLOCKSHIFT = 2;          // Tiles are assigned to owners in 4x4 blocks
+	static constexpr int IDLESPINS = 64;          // Empty polls an idle worker yields for before it starts sleeping
+
+	ParallelAStar(const Grid& grid, int threadCount) : grid(grid), threadCount(std::max(1, threadCount)) {}
+
+	SearchResult<Cost> search(Tile start, Tile end, const std::atomic<bool>* stop = nullptr);
+
+private:
+	typedef typename Cost::type CostType;
+
+	// A route to tile through parent with travel cost g
+	struct Message {
+		Tile tile;
+		Tile parent;
+		CostType g;
+	};
+
+	// Messages travel in batches so each lock-free push carries many tiles
+	struct Batch {
+		std::vector<Message> messages;
+		Batch* next;
+	};
+
+	struct Record {
+		CostType g;
+		Tile parent;
+	};
+
+	struct Entry {
+		CostType f;
+		CostType g;
+		Tile tile;
+	};
+
+	// Lowest fScore first, breaking ties toward the deeper (higher g) entry
+	struct EntryOrder {
+		bool operator()(const Entry& a, const Entry& b) const {
+			return a.f != b.f ? a.f > b.f : a.g < b.g;
+		}
+	};
+
+	// Everything a worker owns, aligned so workers do not share cache lines
+	struct alignas(64) Worker {
+		std::atomic<Batch*> inbox{ nullptr };  // Stack of received batches, pushed by any worker and taken whole by the owner
+		std::priority_queue<Entry, std::vector<Entry>, EntryOrder> openHeap;
+		std::unordered_map<Tile, Record> records;
+		std::vector<Batch*> outgoing;  // Batch being filled for each other worker
+		std::size_t expanded = 0;
+	};
+
+	int ownerOf(int row, int col) const;
+	void work(int id);
+	void expand(int id, const Entry& entry);
+	void receive(Worker& worker, const Message& message);
+	void send(int from, int to, const Message& message);
+	void push(int to, Batch* batch);
+	void flush(int from);
+	void release();
+
+	// Search parameters, only read while the workers run
+	const Grid& grid;
+	int threadCount;
+	Tile start;
+	Tile end;
+	int endRow;
+	int endCol;
+	const std::atomic<bool>* stop;  // Set by another thread to abandon the search, may be null
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	// The shared counters each get their own cache line, so writing one does not
+	// evict the parameters above (or the other counter) from every worker's cache
+
+	// Cost of the best path found so far, only written by the owner of the end tile
+	alignas(64) std::atomic<CostType> incumbent;
+	// Active workers plus messages sent but not yet processed. Idle workers only become
+	// active again by receiving messages, so once this reaches 0 the search is over
+	alignas(64) std::atomic<long long> outstanding;
+};
+
+// Runs the search on threadCount threads (including the calling thread) and returns an optimal path.
+// If stop is set before the search finishes, no path is returned
+template <int Connectivity, typename Cost, typename Grid>
+SearchResult<Cost> ParallelAStar<Connectivity, Cost, Grid>::search(Tile start, Tile end, const std::atomic<bool>* stop) {
+	this->start = start;
+	this->end = end;
+	this->stop = stop;
+	endRow = static_cast<int>(end / grid.cols());
+	endCol = static_cast<int>(end % grid.cols());
+
+	SearchResult<Cost> result;
+	if (start == end) {
+		result.found = true;
+		result.path.push_back(start);
+		return result;
+	}
+
+	workers.clear();
+	for (int i = 0; i < threadCount; i++) {
+		workers.push_back(std::make_unique<Worker>());
+		workers.back()->outgoing.assign(threadCount, nullptr);
+	}
+	incumbent.store(std::numeric_limits<CostType>::max());
+	outstanding.store(threadCount);
+
+	// Seed the start tile with its owner
+	int startRow = static_cast<int>(start / grid.cols());
+	int startCol = static_cast<int>(start % grid.cols());
+	Worker& first = *workers[ownerOf(startRow, startCol)];
+	first.records[start] = Record{ 0, start };
+	first.openHeap.push(Entry{ searchHeuristic<Connectivity, Cost>(startRow, startCol, endRow, endCol), 0, start });
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadCount; i++) {
+		threads.emplace_back(&ParallelAStar::work, this, i);
+	}
+	work(0);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	for (const std::unique_ptr<Worker>& worker : workers) {
+		result.expanded += worker->expanded;
+	}
+	if (stop != nullptr && stop->load()) {
+		release();
+		return result;
+	}
+	if (incumbent.load() == std::numeric_limits<CostType>::max()) { return result; }
+
+	// Walk the parents back to the start, asking each tile's owner for its record.
+	// Every parent had a lower g than its child when linked and g scores only decrease,
+	// so this cannot loop and the traced path costs no more than the incumbent
+	result.found = true;
+	result.cost = incumbent.load();
+	for (Tile tile = end; ; ) {
+		result.path.push_back(tile);
+		if (tile == start) { break; }
+		tile = workers[ownerOf(static_cast<int>(tile / grid.cols()), static_cast<int>(tile % grid.cols()))]->records.at(tile).parent;
+	}
+	std::reverse(result.path.begin(), result.path.end());
+	return result;
+}
+
+// Mixes the block coordinates so neighboring blocks land on unrelated owners
+template <int Connectivity, typename Cost, typename Grid>
+int ParallelAStar<Connectivity, Cost, Grid>::ownerOf(int row, int col) const {
+	std::uint64_t key = (static_cast<std::uint64_t>(row >> BLOCKSHIFT) << 32) | static_cast<std::uint32_t>(col >> BLOCKSHIFT);
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return static_cast<int>(key % static_cast<std::uint64_t>(threadCount));
+}
+
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::work(int id) {
+	Worker& worker = *workers[id];
+	bool active = true;
+	int sinceFlush = 0;
+	int idlePolls = 0;
+
+	while (true) {
+		// Every worker checks the flag itself, so none is left waiting on the others
+		if (stop != nullptr && stop->load(std::memory_order_relaxed)) { break; }
+
+		// Take everything other workers have sent, becoming active again before the
+		// messages stop being counted so outstanding cannot reach 0 in between
+		Batch* batch = worker.inbox.load(std::memory_order_relaxed) ? worker.inbox.exchange(nullptr, std::memory_order_acquire) : nullptr;
+		if (batch != nullptr) {
+			if (!active) {
+				outstanding.fetch_add(1);
+				active = true;
+				idlePolls = 0;
+			}
+			long long received = 0;
+			while (batch != nullptr) {
+				for (const Message& message : batch->messages) {
+					receive(worker, message);
+				}
+				received += static_cast<long long>(batch->messages.size());
+				Batch* next = batch->next;
+				delete batch;
+				batch = next;
+			}
+			outstanding.fetch_sub(received);
+		}
+
+		// Expand the best entry unless it can no longer beat the best path found
+		if (!worker.openHeap.empty() && worker.openHeap.top().f < incumbent.load(std::memory_order_relaxed)) {
+			Entry entry = worker.openHeap.top();
+			worker.openHeap.pop();
+
+			// Skip entries superseded by a cheaper route that arrived after they were queued
+			if (entry.g > worker.records[entry.tile].g) { continue; }
+
+			expand(id, entry);
+			if (++sinceFlush >= FLUSHEVERY) {
+				flush(id);
+				sinceFlush = 0;
+			}
+			continue;
+		}
+
+		// Nothing left worth expanding: send what is buffered and go idle. An idle worker
+		// sends nothing, so this only has to happen once until messages wake it up again
+		if (active) {
+			flush(id);
+			sinceFlush = 0;
+			active = false;
+			outstanding.fetch_sub(1);
+		}
+
+		// Wait for messages or the end of the search, backing off to short sleeps
+		// so idle workers stop hammering the shared counter
+		if (outstanding.load(std::memory_order_acquire) == 0) { break; }
+		if (++idlePolls < IDLESPINS) {
+			std::this_thread::yield();
+		}
+		else {
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	}
+}
+
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::expand(int id, const Entry& entry) {
+	Worker& worker = *workers[id];
+	++worker.expanded;
+
+	Tile parent = worker.records[entry.tile].parent;
+	int row = static_cast<int>(entry.tile / grid.cols());
+	int col = static_cast<int>(entry.tile % grid.cols());
+
+	for (const Step& step : Steps<Connectivity>::list) {
+		int neighborRow = row + step.dRow;
+		int neighborCol = col + step.dCol;
+		if (neighborRow < 0 || neighborRow >= grid.rows() || neighborCol < 0 || neighborCol >= grid.cols()) { continue; }
+		if (grid.isBlocked(neighborRow, neighborCol)) { continue; }
+
+		Tile neighbor = static_cast<Tile>(neighborRow) * grid.cols() + neighborCol;
+		if (neighbor == parent) { continue; }
+
+		Message message{ neighbor, entry.tile, entry.g + ((Connectivity == 8 && step.diagonal) ? Cost::diagonal : Cost::straight) };
+		int owner = ownerOf(neighborRow, neighborCol);
+		if (owner == id) {
+			receive(worker, message);
+		}
+		else {
+			send(id, owner, message);
+		}
+	}
+}
+
+// Record a route to a tile owned by this worker if it is the cheapest seen and could still improve on the incumbent
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::receive(Worker& worker, const Message& message) {
+	int row = static_cast<int>(message.tile / grid.cols());
+	int col = static_cast<int>(message.tile % grid.cols());
+	CostType f = message.g + searchHeuristic<Connectivity, Cost>(row, col, endRow, endCol);
+	if (f >= incumbent.load(std::memory_order_relaxed)) { return; }
+
+	auto [seen, inserted] = worker.records.try_emplace(message.tile, Record{ message.g, message.parent });
+	if (!inserted) {
+		if (message.g >= seen->second.g) { return; }
+		seen->second = Record{ message.g, message.parent };
+	}
+
+	// The end tile never needs expanding, reaching it just tightens the bound
+	if (message.tile == end) {
+		incumbent.store(message.g);
+		return;
+	}
+	worker.openHeap.push(Entry{ f, message.g, message.tile });
+}
+
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::send(int from, int to, const Message& message) {
+	Batch*& batch = workers[from]->outgoing[to];
+	if (batch == nullptr) {
+		batch = new Batch();
+		batch->messages.reserve(BATCHSIZE);
+	}
+	batch->messages.push_back(message);
+	if (batch->messages.size() >= BATCHSIZE) {
+		push(to, batch);
+		batch = nullptr;
+	}
+}
+
+// Count the messages as outstanding, then add the batch to the receiver's inbox
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::push(int to, Batch* batch) {
+	outstanding.fetch_add(static_cast<long long>(batch->messages.size()));
+	std::atomic<Batch*>& inbox = workers[to]->inbox;
+	batch->next = inbox.load(std::memory_order_relaxed);
+	while (!inbox.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::flush(int from) {
+	std::vector<Batch*>& outgoing = workers[from]->outgoing;
+	for (int to = 0; to < threadCount; to++) {
+		if (outgoing[to] != nullptr) {
+			push(to, outgoing[to]);
+			outgoing[to] = nullptr;
+		}
+	}
+}
+
+// Free batches left in inboxes and outgoing buffers when the search was stopped early
+template <int Connectivity, typename Cost, typename Grid>
+void ParallelAStar<Connectivity, Cost, Grid>::release() {
+	for (const std::unique_ptr<Worker>& worker : workers) {
+		Batch* batch = worker->inbox.exchange(nullptr);
+		while (batch != nullptr) {
+			Batch* next = batch->next;
+			delete batch;
+			batch = next;
+		}
+		for (Batch*& outgoing : worker->outgoing) {
+			delete outgoing;
+			outgoing = nullptr;
+		}
+	}
+}
+
+// Convenience wrapper matching aStarSearch
+template <int Connectivity, typename Cost, typename Grid>
+SearchResult<Cost> parallelAStarSearch(const Grid& grid, Tile start, Tile end, int threadCount, const std::atomic<bool>* stop = nullptr) {
+	return ParallelAStar<Connectivity, Cost, Grid>(grid, threadCount).search(start, end, stop);
+}
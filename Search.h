@@ -0,0 +1,188 @@
+#pragma once
+
+#include "World.h"
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <tuple>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+// Movement costs as floats: a straight step costs 1 and a diagonal step costs sqrt(2)
+struct FloatCost {
+	typedef float type;
+	static constexpr type straight = 1.0f;
+	static constexpr type diagonal = 1.4142135f;
+};
+
+// Movement costs as scaled integers (1 -> 10000, sqrt(2) -> 14142), which keeps
+// long paths exact and makes heap comparisons cheaper than with floats
+struct FixedCost {
+	typedef std::uint64_t type;
+	static constexpr type straight = 10000;
+	static constexpr type diagonal = 14142;
+};
+
+// Observer that ignores every search event, so headless searches compile down to the bare loop
+struct NullObserver {
+	void opened(Tile) {}
+	template <typename ParentOf>
+	void expanded(Tile, const ParentOf&) {}
+	bool cancelled() { return false; }
+	void finished(const std::vector<Tile>&) {}
+};
+
+template <typename Cost>
+struct SearchResult {
+	bool found = false;
+	typename Cost::type cost = 0;
+	std::size_t expanded = 0;
+	std::vector<Tile> path;  // Tiles from start to end (inclusive), empty if no path was found
+};
+
+// A single move to a neighboring tile
+struct Step {
+	int dRow;
+	int dCol;
+	bool diagonal;
+};
+
+// Neighbor offsets in row-major order for each supported connectivity
+template <int Connectivity>
+struct Steps;
+
+template <>
+struct Steps<4> {
+	static constexpr Step list[4] = { {-1, 0, false}, {0, -1, false}, {0, 1, false}, {1, 0, false} };
+};
+
+template <>
+struct Steps<8> {
+	static constexpr Step list[8] = {
+		{-1, -1, true}, {-1, 0, false}, {-1, 1, true},
+		{0, -1, false}, {0, 1, false},
+		{1, -1, true}, {1, 0, false}, {1, 1, true}
+	};
+};
+
+// Manhattan distance for 4-connected grids and octile distance for 8-connected grids,
+// both scaled by the cost type so the heuristic never overestimates
+template <int Connectivity, typename Cost>
+inline typename Cost::type searchHeuristic(int rowFrom, int colFrom, int rowTo, int colTo) {
+	typedef typename Cost::type CostType;
+	CostType dRow = static_cast<CostType>(std::abs(rowFrom - rowTo));
+	CostType dCol = static_cast<CostType>(std::abs(colFrom - colTo));
+	if constexpr (Connectivity == 8) {
+		// Take as many diagonal steps as possible, then walk straight the rest of the way
+		CostType diag = std::min(dRow, dCol);
+		return Cost::diagonal * diag + Cost::straight * (dRow + dCol - 2 * diag);
+	}
+	else {
+		return Cost::straight * (dRow + dCol);
+	}
+}
+
+// A* over any grid exposing rows(), cols() and isBlocked(row, col), such as World.
+// Connectivity (4 or 8) and the cost type are fixed at compile time so the inner loop
+// has no runtime branching on either; the observer receives search events and can cancel.
+template <int Connectivity, typename Cost, typename Grid, typename Observer>
+SearchResult<Cost> aStarSearch(const Grid& grid, Tile start, Tile end, Observer& observer) {
+	static_assert(Connectivity == 4 || Connectivity == 8, "Only 4 and 8 connected grids are supported");
+	typedef typename Cost::type CostType;
+
+	// Elements in the open heap (min priority queue) are stored as a
+	// tuple (fScore, unsigned int accumulator, Tile tile)
+	// and are sorted by their fScores
+	typedef std::tuple<CostType, unsigned int, Tile> node;
+
+	// Everything known about a seen tile, kept together so each neighbor costs a single lookup
+	struct Record {
+		CostType g;
+		Tile parent;
+		bool closed;
+	};
+
+	const int rowCount = grid.rows();
+	const int colCount = grid.cols();
+	const int endRow = static_cast<int>(end / colCount);
+	const int endCol = static_cast<int>(end % colCount);
+
+	SearchResult<Cost> result;
+	std::priority_queue<node, std::vector<node>, std::greater<node>> openHeap;
+	std::unordered_map<Tile, Record> records;  // References stay valid across rehashes
+
+	// The start tile is its own parent, which marks the end of a traced path
+	auto parentOf = [&records](Tile tile) {
+		auto found = records.find(tile);
+		return found == records.end() ? tile : found->second.parent;
+	};
+
+	// For use in tiebreakers between equal fScores
+	unsigned int accumulator = std::numeric_limits<unsigned int>::max();
+	records[start] = Record{ 0, start, false };
+	openHeap.push(node(searchHeuristic<Connectivity, Cost>(static_cast<int>(start / colCount), static_cast<int>(start % colCount), endRow, endCol), accumulator, start));
+
+	while (!openHeap.empty()) {
+		Tile current = std::get<2>(openHeap.top());
+		openHeap.pop();
+		Record& record = records[current];
+		if (record.closed) { continue; }
+
+		record.closed = true;
+		++result.expanded;
+
+		// Walk the parents back to the start to build the path
+		if (current == end) {
+			result.found = true;
+			result.cost = record.g;
+			for (Tile tile = end; ; tile = parentOf(tile)) {
+				result.path.push_back(tile);
+				if (tile == start) { break; }
+			}
+			std::reverse(result.path.begin(), result.path.end());
+			observer.finished(result.path);
+			return result;
+		}
+
+		observer.expanded(current, parentOf);
+
+		// Forces alternating movements for a cleaner looking path
+		// see https://www.redblobgames.com/pathfinding/a-star/implementation.html#troubleshooting-ugly-path
+		int row = static_cast<int>(current / colCount);
+		int col = static_cast<int>(current % colCount);
+		bool reversed = (row + col) % 2 == 0;
+
+		for (int i = 0; i < Connectivity; ++i) {
+			const Step& step = Steps<Connectivity>::list[reversed ? Connectivity - 1 - i : i];
+			int neighborRow = row + step.dRow;
+			int neighborCol = col + step.dCol;
+			if (neighborRow < 0 || neighborRow >= rowCount || neighborCol < 0 || neighborCol >= colCount) { continue; }
+			if (grid.isBlocked(neighborRow, neighborCol)) { continue; }
+
+			Tile neighbor = static_cast<Tile>(neighborRow) * colCount + neighborCol;
+			CostType newG = record.g + ((Connectivity == 8 && step.diagonal) ? Cost::diagonal : Cost::straight);
+
+			// If this is the first time this node has been seen or if the current
+			// travel cost to it is lower than previously seen, record the new
+			// lowest score and parent, and add it to the nodes to explore.
+			// (This may add duplicate tile entries, but it is rare and does not break admissibility)
+			auto [seen, inserted] = records.try_emplace(neighbor, Record{ newG, current, false });
+			if (!inserted) {
+				if (seen->second.closed || newG >= seen->second.g) { continue; }
+				seen->second.g = newG;
+				seen->second.parent = current;
+			}
+			openHeap.push(node(newG + searchHeuristic<Connectivity, Cost>(neighborRow, neighborCol, endRow, endCol), --accumulator, neighbor));
+			observer.opened(neighbor);
+		}
+
+		if (observer.cancelled()) { return result; }
+	}
+
+	observer.finished(result.path);
+	return result;
+}
@@ -1,32 +1,55 @@
 #include "Visualizer.h"
+#include "Search.h"
+#include "ParallelSearch.h"
 #include <vector>
-#include <unordered_set>
 #include <unordered_map>
 #include <queue>
 #include <algorithm>
+#include <numeric>
 #include <cmath>
 #include <tuple>
 #include <limits>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 #define SFML_DEFINE_DISCRETE_GPU_PREFERENCE
 
-Visualizer::Visualizer(int width, int height, int squarePix, int padding, int fps, int frameskip, bool diagonal) : 
+// rows and cols of 0 size the world to fill the window at the starting zoom
+Visualizer::Visualizer(int width, int height, int rows, int cols, int squarePix, int padding, int fps, int frameskip, bool diagonal, bool floatCosts, int threads) :
 	rng(std::random_device()()),
+	world(rows > 0 ? rows : static_cast<int>(height / static_cast<float>(squarePix + padding)),
+	      cols > 0 ? cols : static_cast<int>(width / static_cast<float>(squarePix + padding))),
 	window(sf::VideoMode(width, height), "Pathfinding Visualization", sf::Style::Titlebar | sf::Style::Close) {
 
+	this->width = width;
+	this->height = height;
 	desiredFps = fps;
 	window.setFramerateLimit(fps);
 	this->frameskip = frameskip;
+	frame = 0;
+	threadCount = threads;
 	tileSpacing = padding;
 	moveDiagonal = diagonal;
-	moveVal = static_cast<float>(squarePix + padding);
-	rowCount = static_cast<int>(height / moveVal);
-	colCount = static_cast<int>(width / moveVal);
+	useFloatCosts = floatCosts;
+	rowCount = world.rows();
+	colCount = world.cols();
 	start = 0;
-	end = (rowCount - 1) * colCount + colCount - 1;
+	end = world.tileAt(rowCount - 1, colCount - 1);
+
+	// Zooming out stops once the whole world fits or tiles reach a single pixel,
+	// which bounds the render data to roughly one quad per window pixel
+	tilePix = static_cast<float>(squarePix + padding);
+	float fitPix = std::min(width / static_cast<float>(colCount), height / static_cast<float>(rowCount));
+	minTilePix = std::max(1.0f, std::min(tilePix, fitPix));
+	maxTilePix = std::max(tilePix, 64.0f);
+	viewRow = 0.0f;
+	viewCol = 0.0f;
+	panning = false;
+	viewDirty = false;
+
+	palette.push_back(sf::Color::Transparent);
 	tileVertices.setPrimitiveType(sf::Quads);
-	tileVertices.resize(rowCount * colCount * 4);
-	tiles.resize(rowCount * colCount, false);
 	blankTileVertices();
 }
 
@@ -47,6 +70,8 @@ void Visualizer::run() {
 	while (window.isOpen()) {
 		sf::Event event;
 		while (window.pollEvent(event)) {
+			if (handleViewEvent(event)) { continue; }
+
 			switch (event.type) {
 			case sf::Event::Closed:
 				window.close();
@@ -74,8 +99,13 @@ void Visualizer::run() {
 					aStar();
 					drawing = false;
 					break;
+				case sf::Keyboard::P:
+					blankTileVertices();
+					parallelAStar();
+					drawing = false;
+					break;
 				case sf::Keyboard::R:
-					setAllTiles(false);
+					world.setAll(false);
 					blankTileVertices();
 					drawing = true;
 					break;
@@ -110,20 +140,104 @@ void Visualizer::run() {
 	}
 }
 
-// Update the screen 
+// Update the screen
 void Visualizer::draw() {
 	if (++frame < frameskip) { return; }
 
 	frame = 0;
+	if (viewDirty) { updateView(); }
 	window.clear(COLORGRAY);
 	window.draw(tileVertices);
 	window.display();
 }
 
-// Keep window responsive and respond to quit
+// Pan with the arrow keys or by dragging with the middle mouse button,
+// and zoom with the mouse wheel or +/-. Returns true if the event was used
+bool Visualizer::handleViewEvent(const sf::Event& event) {
+	switch (event.type) {
+	case sf::Event::MouseWheelScrolled:
+		zoomView(std::pow(1.25f, event.mouseWheelScroll.delta), event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+		return true;
+	case sf::Event::MouseButtonPressed:
+		if (event.mouseButton.button != sf::Mouse::Middle) { return false; }
+		panning = true;
+		panFrom = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+		return true;
+	case sf::Event::MouseButtonReleased:
+		if (event.mouseButton.button != sf::Mouse::Middle) { return false; }
+		panning = false;
+		return true;
+	case sf::Event::MouseMoved:
+		if (!panning) { return false; }
+		panView((panFrom.y - event.mouseMove.y) / tilePix, (panFrom.x - event.mouseMove.x) / tilePix);
+		panFrom = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+		return true;
+	case sf::Event::KeyPressed: {
+		// Arrow keys move an eighth of the window at a time
+		float rowStep = std::max(1.0f, height / tilePix / 8);
+		float colStep = std::max(1.0f, width / tilePix / 8);
+		switch (event.key.code) {
+		case sf::Keyboard::Up:
+			panView(-rowStep, 0.0f);
+			return true;
+		case sf::Keyboard::Down:
+			panView(rowStep, 0.0f);
+			return true;
+		case sf::Keyboard::Left:
+			panView(0.0f, -colStep);
+			return true;
+		case sf::Keyboard::Right:
+			panView(0.0f, colStep);
+			return true;
+		case sf::Keyboard::Equal:
+		case sf::Keyboard::Add:
+			zoomView(1.25f, width / 2, height / 2);
+			return true;
+		case sf::Keyboard::Hyphen:
+		case sf::Keyboard::Subtract:
+			zoomView(0.8f, width / 2, height / 2);
+			return true;
+		default:
+			return false;
+		}
+	}
+	default:
+		return false;
+	}
+}
+
+// Move the camera by a number of tiles. The quads are rebuilt on the next
+// drawn frame, so many events in one frame only cost a single rebuild
+void Visualizer::panView(float rows, float cols) {
+	viewRow += rows;
+	viewCol += cols;
+	clampView();
+	viewDirty = true;
+}
+
+// Scale the tiles while keeping the tile under the given pixel in place
+void Visualizer::zoomView(float factor, int pixelX, int pixelY) {
+	float anchorRow = viewRow + pixelY / tilePix;
+	float anchorCol = viewCol + pixelX / tilePix;
+	tilePix = std::clamp(tilePix * factor, minTilePix, maxTilePix);
+	viewRow = anchorRow - pixelY / tilePix;
+	viewCol = anchorCol - pixelX / tilePix;
+	clampView();
+	viewDirty = true;
+}
+
+// Keep the camera inside the world
+void Visualizer::clampView() {
+	viewRow = std::clamp(viewRow, 0.0f, std::max(0.0f, rowCount - height / tilePix));
+	viewCol = std::clamp(viewCol, 0.0f, std::max(0.0f, colCount - width / tilePix));
+}
+
+// Keep window responsive and respond to quit (the camera can still be moved)
 bool Visualizer::checkQuit() {
 	sf::Event event;
 	while (window.pollEvent(event)) {
+		if (handleViewEvent(event)) { continue; }
+
 		if (event.type == sf::Event::Closed) {
 			window.close();
 			return true;
@@ -135,92 +249,119 @@ bool Visualizer::checkQuit() {
 	return false;
 }
 
-// Check if 2 tiles are perfectly diagonal (at any distance) by comparing
-// their row and column difference magnitudes
-bool Visualizer::isDiagonal(int from, int to) {
-	int rowFrom = from / colCount;
-	int colFrom = from % colCount;
-	int rowTo = to / colCount;
-	int colTo = to % colCount;
-	return std::abs(rowFrom - rowTo) == std::abs(colFrom - colTo);
-}
-
-bool Visualizer::isDiagonal(int rowFrom, int colFrom, int rowTo, int colTo) {
-	return std::abs(rowFrom - rowTo) == std::abs(colFrom - colTo);
-}
-
-// Check if 2 tiles are in a perfectly horizontal/vertical line
-bool Visualizer::isStraight(int from, int to) {
-	int rowFrom = from / colCount;
-	int colFrom = from % colCount;
-	int rowTo = to / colCount;
-	int colTo = to % colCount;
-	return (rowFrom == rowTo || colFrom == colTo);
+// Returns the palette slot for a color, adding it the first time it is used
+std::uint8_t Visualizer::paletteIndex(sf::Color color) {
+	for (std::size_t i = 1; i < palette.size(); i++) {
+		if (palette[i] == color) { return static_cast<std::uint8_t>(i); }
+	}
+	palette.push_back(color);
+	return static_cast<std::uint8_t>(palette.size() - 1);
 }
 
-bool Visualizer::isStraight(int rowFrom, int colFrom, int rowTo, int colTo) {
-	return (rowFrom == rowTo || colFrom == colTo);
+// Color a specific tile by index with a provided color, updating its quad if it is on screen
+void Visualizer::colorQuad(Tile tile, sf::Color color) {
+	int row = world.rowOf(tile);
+	int col = world.colOf(tile);
+	std::vector<std::uint8_t>& colors = overlay[world.chunkOf(row, col)];
+	if (colors.empty()) {
+		colors.resize(World::CHUNKSIZE * World::CHUNKSIZE, 0);
+	}
+	colors[World::offsetInChunk(row, col)] = paletteIndex(color);
+	colorVisibleQuad(row, col, color);
 }
 
-// Color a specific tile by index with a provided color
-void Visualizer::colorQuad(int tile, sf::Color color) {
-	sf::Vertex* quad = &tileVertices[tile * 4];
+// Recolor a tile's quad if it is currently on screen, without touching the overlay
+void Visualizer::colorVisibleQuad(int row, int col, sf::Color color) {
+	if (row < firstRow || row >= firstRow + visibleRows || col < firstCol || col >= firstCol + visibleCols) { return; }
+	sf::Vertex* quad = &tileVertices[((row - firstRow) * visibleCols + (col - firstCol)) * 4];
 	for (int i = 0; i < 4; i++) {
 		quad[i].color = color;
 	}
 }
 
-// Reset all open tiles to white and all blocked tiles to black
-// Start and end get their own special colors
-void Visualizer::blankTileVertices() {
-	for (int row = 0; row < rowCount; row++) {
-		for (int col = 0; col < colCount; col++) {
-			sf::Vertex* quad = &tileVertices[(row * colCount + col) * 4];
-			quad[0].position = sf::Vector2f(col * moveVal, row * moveVal);
-			quad[1].position = sf::Vector2f((col + 1) * moveVal - tileSpacing, row * moveVal);
-			quad[2].position = sf::Vector2f((col + 1) * moveVal - tileSpacing, (row + 1) * moveVal - tileSpacing);
-			quad[3].position = sf::Vector2f(col * moveVal, (row + 1) * moveVal - tileSpacing);
-			sf::Color tileColor = (tiles[row * colCount + col]) ? sf::Color::Black : sf::Color::White;
-			for (int i = 0; i < 4; i++) {
-				quad[i].color = tileColor;
+// Rebuild the quads for the tiles inside the window, one chunk at a time.
+// Tiles with no overlay color are drawn black when blocked and white when open
+void Visualizer::updateView() {
+	viewDirty = false;
+	clampView();
+	firstRow = static_cast<int>(viewRow);
+	firstCol = static_cast<int>(viewCol);
+	visibleRows = std::min(rowCount - firstRow, static_cast<int>(std::ceil(height / tilePix)) + 1);
+	visibleCols = std::min(colCount - firstCol, static_cast<int>(std::ceil(width / tilePix)) + 1);
+	tileVertices.resize(static_cast<std::size_t>(visibleRows) * visibleCols * 4);
+
+	// Padding is dropped once tiles get too small for it to leave anything visible
+	float spacing = (tilePix > tileSpacing * 3) ? static_cast<float>(tileSpacing) : 0.0f;
+	int lastRow = firstRow + visibleRows - 1;
+	int lastCol = firstCol + visibleCols - 1;
+
+	for (int chunkRow = firstRow >> World::CHUNKSHIFT; chunkRow <= lastRow >> World::CHUNKSHIFT; chunkRow++) {
+		for (int chunkCol = firstCol >> World::CHUNKSHIFT; chunkCol <= lastCol >> World::CHUNKSHIFT; chunkCol++) {
+			int rowBegin = std::max(firstRow, chunkRow << World::CHUNKSHIFT);
+			int rowEnd = std::min(lastRow, ((chunkRow + 1) << World::CHUNKSHIFT) - 1);
+			int colBegin = std::max(firstCol, chunkCol << World::CHUNKSHIFT);
+			int colEnd = std::min(lastCol, ((chunkCol + 1) << World::CHUNKSHIFT) - 1);
+
+			auto found = overlay.find(world.chunkOf(rowBegin, colBegin));
+			const std::uint8_t* colors = (found == overlay.end()) ? nullptr : found->second.data();
+
+			for (int row = rowBegin; row <= rowEnd; row++) {
+				float top = (row - viewRow) * tilePix;
+				for (int col = colBegin; col <= colEnd; col++) {
+					float left = (col - viewCol) * tilePix;
+					sf::Vertex* quad = &tileVertices[((row - firstRow) * visibleCols + (col - firstCol)) * 4];
+					quad[0].position = sf::Vector2f(left, top);
+					quad[1].position = sf::Vector2f(left + tilePix - spacing, top);
+					quad[2].position = sf::Vector2f(left + tilePix - spacing, top + tilePix - spacing);
+					quad[3].position = sf::Vector2f(left, top + tilePix - spacing);
+
+					std::uint8_t colorIndex = colors ? colors[World::offsetInChunk(row, col)] : 0;
+					sf::Color tileColor = colorIndex != 0 ? palette[colorIndex] : (world.isBlocked(row, col) ? sf::Color::Black : sf::Color::White);
+					for (int i = 0; i < 4; i++) {
+						quad[i].color = tileColor;
+					}
+				}
 			}
 		}
 	}
-
-	sf::Vertex* st = &tileVertices[start * 4];
-	sf::Vertex* fn = &tileVertices[end * 4];
-	for (int i = 0; i < 4; i++) {
-		st[i].color = sf::Color::Cyan;
-		fn[i].color = sf::Color::Magenta;
-	}
 }
 
-// Unblock or block all nodes/tiles
-void Visualizer::setAllTiles(bool blocked) {
-	for (int i = 0; i < rowCount * colCount; i++) {
-		tiles[i] = blocked;
-	}
+// Reset all open tiles to white and all blocked tiles to black
+// Start and end get their own special colors
+void Visualizer::blankTileVertices() {
+	overlay.clear();
+	updateView();
+	colorQuad(start, sf::Color::Cyan);
+	colorQuad(end, sf::Color::Magenta);
 }
 
-// Takes vector of window mouse pos and returns an int representing square index
+// Takes vector of window mouse pos and returns the index of the tile under it
 // Note: coordinates on the "border" for a tile will still count
-int Visualizer::getHoveredSquare() {
+Tile Visualizer::getHoveredSquare() {
 	sf::Vector2i coordinates = sf::Mouse::getPosition(window);
 	// Clamps to a valid square
-	int col = std::clamp(static_cast<int>(coordinates.x / moveVal), 0, colCount - 1);
-	int row = std::clamp(static_cast<int>(coordinates.y / moveVal), 0, rowCount - 1);
-	return row * colCount + col;
+	int col = std::clamp(static_cast<int>(viewCol + coordinates.x / tilePix), 0, colCount - 1);
+	int row = std::clamp(static_cast<int>(viewRow + coordinates.y / tilePix), 0, rowCount - 1);
+	return world.tileAt(row, col);
 }
 
-// Changes the open/closed status of a tile and recolors it based on that
-void Visualizer::setBlocked(int tile, bool blocked) {
-	tiles[tile] = blocked;
-	colorQuad(tile, blocked ? sf::Color::Black : sf::Color::White);
+// Changes the open/closed status of a tile and recolors it based on that.
+// Walls are drawn from the world itself, so this only clears any overlay color
+// and never allocates overlay for chunks that have not been colored
+void Visualizer::setBlocked(Tile tile, bool blocked) {
+	world.setBlocked(tile, blocked);
+	int row = world.rowOf(tile);
+	int col = world.colOf(tile);
+	auto found = overlay.find(world.chunkOf(row, col));
+	if (found != overlay.end()) {
+		found->second[World::offsetInChunk(row, col)] = 0;
+	}
+	colorVisibleQuad(row, col, blocked ? sf::Color::Black : sf::Color::White);
 }
 
 // Modify tile spaces with current mouse position given clicks (except start/end)
 void Visualizer::handleClicks(bool leftClick, bool rightClick) {
-	int square = getHoveredSquare();
+	Tile square = getHoveredSquare();
 	if (square == start || square == end) { return; }
 
 	if (leftClick) {
@@ -232,7 +373,7 @@ void Visualizer::handleClicks(bool leftClick, bool rightClick) {
 }
 
 // Sets the starting square if it would not overwrite the end (and colors it)
-void Visualizer::setStart(int tile, bool blockOriginal) {
+void Visualizer::setStart(Tile tile, bool blockOriginal) {
 	if (tile != end) {
 		setBlocked(start, blockOriginal);
 		setBlocked(tile, false);
@@ -242,7 +383,7 @@ void Visualizer::setStart(int tile, bool blockOriginal) {
 }
 
 // Sets the ending square if it would not overwrite the start (and colors it)
-void Visualizer::setEnd(int tile, bool blockOriginal) {
+void Visualizer::setEnd(Tile tile, bool blockOriginal) {
 	if (tile != start) {
 		setBlocked(end, blockOriginal);
 		setBlocked(tile, false);
@@ -251,67 +392,26 @@ void Visualizer::setEnd(int tile, bool blockOriginal) {
 	}
 }
 
-// Manhattan distance heuristic
-float Visualizer::heuristic(int from, int to) {
-	int rowFrom = from / colCount;
-	int colFrom = from % colCount;
-	int rowTo = to / colCount;
-	int colTo = to % colCount;
-	return static_cast<float>(std::abs(rowFrom - rowTo) + std::abs(colFrom - colTo));
-}
-
-// Clears neighbors and modifies it to contain neighbors surrounding the given tile
-// int distance determines how far away it will look for neighbors
-// bool blocked determines which tiles it should get (true = blocked, false = open)
-void Visualizer::getNeighbors(std::vector<int>& neighbors, int tile, bool includeStraight, bool includeDiag, bool blocked, int distance) {
+// Clears neighbors and modifies it to contain the maze cells two tiles away
+// in each straight direction (regardless of whether they are open)
+void Visualizer::getCellNeighbors(std::vector<Tile>& neighbors, Tile tile) {
 	neighbors.clear();
-	// Avoid looking outside the vector bounds when the tile is next to an edge
-	int row = tile / colCount;
-	int col = tile % colCount;
-	int rowStart = std::max(row - distance, 0);
-	int rowEnd = std::min(row + distance, rowCount - 1);
-	int colStart = std::max(col - distance, 0);
-	int colEnd = std::min(col + distance, colCount - 1);
-
-	for (int rowi = rowStart; rowi <= rowEnd; rowi++) {
-		for (int coli = colStart; coli <= colEnd; coli++) {
-			if (rowi == row && coli == col) { continue; } // Skips provided tile
-
-			// Skip adding the neighbor if it does not meet the requirements (includeStraight/includeDiag)
-			if (!((includeStraight && isStraight(row, col, rowi, coli)) || (includeDiag && isDiagonal(row, col, rowi, coli)))) { continue; }
-
-			// If the new tile matches desired blocked status, include it
-			int newTile = rowi * colCount + coli;
-			if (tiles[newTile] == blocked) {
-				neighbors.push_back(newTile);
-			}
-		}
-	}
-
-	// Forces alternating movements for a cleaner looking path
-	// see https://www.redblobgames.com/pathfinding/a-star/implementation.html#troubleshooting-ugly-path
-	if ((row + col) % 2 == 0) {
-		std::reverse(neighbors.begin(), neighbors.end());
-	}
-}
-
-void Visualizer::getNeighbors(std::vector<int>& neighbors, int tile, bool blocked) {
-	getNeighbors(neighbors, tile, true, moveDiagonal, blocked);
+	int row = world.rowOf(tile);
+	int col = world.colOf(tile);
+	if (row >= 2) { neighbors.push_back(world.tileAt(row - 2, col)); }
+	if (col >= 2) { neighbors.push_back(world.tileAt(row, col - 2)); }
+	if (col + 2 < colCount) { neighbors.push_back(world.tileAt(row, col + 2)); }
+	if (row + 2 < rowCount) { neighbors.push_back(world.tileAt(row + 2, col)); }
 }
 
-// Set everything to walls and then place open tiles separated by one wall
+// Set everything to walls. Maze cells are the tiles on odd rows and columns, and a cell
+// is part of the maze once it has been opened, so no separate visited set is needed
 void Visualizer::initMaze() {
-	setAllTiles(true);
+	world.setAll(true);
 	blankTileVertices();
 
 	setBlocked(start, true);
 	setBlocked(end, true);
-
-	for (int row = 1; row < rowCount; row += 2) {
-		for (int col = 1; col < colCount; col += 2) {
-			tiles[row * colCount + col] = false;
-		}
-	}
 }
 
 // Attempt to find and place start and end squares in open spaces
@@ -320,9 +420,8 @@ void Visualizer::createStartEnd() {
 	for (int row = 0; row < rowCount; ++row) {
 		if (startPlaced) { break; }
 		for (int col = 0; col < colCount; ++col) {
-			int tile = row * colCount + col;
-			if (!tiles[tile]) {
-				setStart(tile, tiles[start]);
+			if (!world.isBlocked(row, col)) {
+				setStart(world.tileAt(row, col), world.isBlocked(start));
 				startPlaced = true;
 				break;
 			}
@@ -333,9 +432,8 @@ void Visualizer::createStartEnd() {
 	for (int row = rowCount - 1; row >= 0; --row) {
 		if (endPlaced) { break; }
 		for (int col = colCount - 1; col >= 0; --col) {
-			int tile = row * colCount + col;
-			if (!tiles[tile]) {
-				setEnd(tile, tiles[end]);
+			if (!world.isBlocked(row, col)) {
+				setEnd(world.tileAt(row, col), world.isBlocked(end));
 				endPlaced = true;
 				break;
 			}
@@ -349,57 +447,59 @@ void Visualizer::mazeWilsons() {
 	initMaze();
 	draw();
 
-	std::vector<int> neighbors;
-	std::unordered_set<int> cellsInMaze;
-	std::vector<int> cellsToExplore;
-	for (int row = 1; row < rowCount; row += 2) {
-		for (int col = 1; col < colCount; col += 2) {
-			cellsToExplore.push_back(row * colCount + col);
-		}
-	}
+	// Maze cells numbered in row-major order
+	std::vector<Tile> neighbors;
+	Tile cellCols = colCount / 2;
+	Tile cellCount = static_cast<Tile>(rowCount / 2) * cellCols;
+	auto cellTile = [&](Tile cell) {
+		return world.tileAt(static_cast<int>(cell / cellCols) * 2 + 1, static_cast<int>(cell % cellCols) * 2 + 1);
+	};
 
-	// Pick 1 random cell, make it the initial target cell, and move it from cellsToExplore -> cellsInMaze
-	int index = std::uniform_int_distribution<int>(0, cellsToExplore.size() - 1)(rng);
-	int tile = cellsToExplore[index];
-	cellsToExplore.erase(cellsToExplore.begin() + index);
-	cellsInMaze.insert(tile);
+	// Pick 1 random cell and make it the initial target cell
+	Tile tile = cellTile(std::uniform_int_distribution<Tile>(0, cellCount - 1)(rng));
+	world.setBlocked(tile, false);
 	colorQuad(tile, sf::Color::Green);
 
-	while (!cellsToExplore.empty()) {
-		std::unordered_map<int, int> previous;
+	// Start walks from every cell in a scattered order by stepping through the cells with a
+	// random stride coprime to their count, which visits each cell once without storing a list
+	Tile stride = 1;
+	if (cellCount > 2) {
+		do {
+			stride = std::uniform_int_distribution<Tile>(1, cellCount - 1)(rng);
+		} while (std::gcd(stride, cellCount) != 1);
+	}
+	Tile offset = std::uniform_int_distribution<Tile>(0, cellCount - 1)(rng);
+
+	for (Tile step = 0; step < cellCount; ++step) {
+		// Choose the next position to start a random walk from, skipping cells already in the maze
+		Tile walkStart = cellTile((offset + step * stride) % cellCount);
+		if (!world.isBlocked(walkStart)) { continue; }
 
-		// Choose a random position to start a random walk from
-		int walkStart = cellsToExplore[std::uniform_int_distribution<int>(0, cellsToExplore.size() - 1)(rng)];
-		int current = walkStart;
-		cellsToExplore.erase(std::remove(cellsToExplore.begin(), cellsToExplore.end(), current), cellsToExplore.end());
+		std::unordered_map<Tile, Tile> previous;
+		Tile current = walkStart;
 
 		// Point the previous tile for the start of the walk to itself for ease of processing
 		previous[current] = current;
 
 		while (true) {
-			// Avoid moving directly back into the previous path
-			getNeighbors(neighbors, current, true, false, false, 2);
-			if (previous.find(current) != previous.end()) {
+			// Avoid moving directly back into the previous path (unless it is the only way out)
+			getCellNeighbors(neighbors, current);
+			if (neighbors.size() > 1) {
 				neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), previous[current]), neighbors.end());
 			}
-			int newTile = neighbors[std::uniform_int_distribution<int>(0, neighbors.size() - 1)(rng)];
+			Tile newTile = neighbors[std::uniform_int_distribution<std::size_t>(0, neighbors.size() - 1)(rng)];
 
-			// The reached cell is in the maze, so add the entire walked path to cellsInMaze and remove them from the nodes to explore
-			if (cellsInMaze.count(newTile) == 1) {
+			// The reached cell is in the maze, so open the entire walked path
+			if (!world.isBlocked(newTile)) {
 				previous[newTile] = current;
-				int loopCurrent = newTile;
+				Tile loopCurrent = newTile;
 				// Include the walk's starting cell
 				setBlocked(walkStart, false);
-				cellsInMaze.insert(walkStart);
 
 				for (; previous[loopCurrent] != loopCurrent; loopCurrent = previous[loopCurrent]) {
-					cellsInMaze.insert(loopCurrent);
 					setBlocked(loopCurrent, false);
 
-					// Remove the cell from list of cells to explore in the future
-					cellsToExplore.erase(std::remove(cellsToExplore.begin(), cellsToExplore.end(), loopCurrent), cellsToExplore.end());
-
-					int wall = (loopCurrent + previous[loopCurrent]) / 2;
+					Tile wall = (loopCurrent + previous[loopCurrent]) / 2;
 					setBlocked(wall, false);
 				}
 
@@ -409,15 +509,15 @@ void Visualizer::mazeWilsons() {
 
 			// The reached cell is a part of the walked path, so remove the part of the path that loops
 			if (previous.count(newTile) == 1) {
-				int loopCurrent = current;
+				Tile loopCurrent = current;
 				// Iterate through the walk until the previous tile would be newTile, removing the loop path from previous in the process
 				while (loopCurrent != newTile) {
 					colorQuad(loopCurrent, sf::Color::Black);
 
-					int wall = (loopCurrent + previous[loopCurrent]) / 2;
+					Tile wall = (loopCurrent + previous[loopCurrent]) / 2;
 					colorQuad(wall, sf::Color::Black);
 
-					int old = loopCurrent;
+					Tile old = loopCurrent;
 					loopCurrent = previous[loopCurrent];
 					previous.erase(old);
 				}
@@ -430,7 +530,7 @@ void Visualizer::mazeWilsons() {
 			// Otherwise, it's just another addition to the random walk, so the previous position is recorded and the new part of the path is colored
 			previous[newTile] = current;
 			colorQuad(current, sf::Color::Magenta);
-			int wall = (current + newTile) / 2;
+			Tile wall = (current + newTile) / 2;
 			colorQuad(wall, sf::Color::Magenta);
 
 			current = newTile;
@@ -451,36 +551,30 @@ void Visualizer::mazeWilsons() {
 void Visualizer::mazeDepthFirstSearch() {
 	initMaze();
 
-	std::deque<int> stack;
-	std::unordered_set<int> visited;
-	std::vector<int> neighbors;
-	int start = std::uniform_int_distribution<int>(0, rowCount * colCount - 1)(rng);
-	if (tiles[start]) {
-		getNeighbors(neighbors, start, true, true, false, 2);
-		start = neighbors[0];
-	}
+	std::deque<Tile> stack;
+	std::vector<Tile> neighbors;
+	int startRow = std::uniform_int_distribution<int>(0, rowCount / 2 - 1)(rng) * 2 + 1;
+	int startCol = std::uniform_int_distribution<int>(0, colCount / 2 - 1)(rng) * 2 + 1;
+	Tile start = world.tileAt(startRow, startCol);
 	setBlocked(start, false);
 	stack.push_back(start);
-	visited.insert(start);
-	
+
 	while (!stack.empty()) {
-		int current = stack.back();
+		Tile current = stack.back();
 		stack.pop_back();
 
-		// Filter out already visited neighbors
-		getNeighbors(neighbors, current, true, false, false, 2);
-		neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [&visited](int tile) {return visited.count(tile) == 1;}), neighbors.end());
+		// Filter out already visited (opened) neighbors
+		getCellNeighbors(neighbors, current);
+		neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [this](Tile tile) {return !world.isBlocked(tile);}), neighbors.end());
 		if (neighbors.size() == 0) { continue; }
 
 		// Choose a random neighbor, and remove the wall between chosen and current
 		stack.push_back(current);
-		int chosen = neighbors[std::uniform_int_distribution<int>(0, neighbors.size() - 1)(rng)];
+		Tile chosen = neighbors[std::uniform_int_distribution<std::size_t>(0, neighbors.size() - 1)(rng)];
 		setBlocked(chosen, false);
 		stack.push_back(chosen);
-		visited.insert(chosen);
-		int wall = (current + chosen) / 2;
+		Tile wall = (current + chosen) / 2;
 		setBlocked(wall, false);
-		visited.insert(wall);
 
 		// Keep window responsive, respond to quit, and draw to the screen
 		if (checkQuit()) { return; }
@@ -492,101 +586,124 @@ void Visualizer::mazeDepthFirstSearch() {
 	draw();
 }
 
-// Runs A* on the grid and draws progress simultaneously
-void Visualizer::aStar() {
-	// Elements in the open heap (min priority queue) are stored as a
-	// tuple (float fScore, unsigned int accumulator, int tile)
-	// and are sorted by their float fScores
-	typedef std::tuple<float, unsigned int, int> node;
-	std::priority_queue<node, std::vector<node>, std::greater<node>> openHeap;
-	std::unordered_set<int> closedSet;         // For fast membership checking of already explored nodes
-	std::unordered_map<int, int> prevConnect;  // Maps a tile to their parent
-	std::unordered_map<int, float> gScores;    // G score for nodes
-	std::vector<int> neighbors;  // Holds the neighbors of the single tile being looked at
-	gScores[start] = 0.0f;
-
-	// For use in tiebreakers (nodes added first are explored first)
-	unsigned int accumulator = std::numeric_limits<unsigned int>::max();
-	openHeap.push(node(0.0f, accumulator, start));
-
-	// For drawing/undrawing last path from start looked at (every x frames)
-	std::vector<int> lastPath;
-	int curPath = start;
-	int frame = 0;
-
-	// Dictates how many frames to wait inbetween path display
-	int pathEvery = desiredFps == 0 ? 240 : desiredFps / 30;
-	pathEvery += frameskip * 5;
+// Receives events from the search kernel and draws its progress
+class Visualizer::SearchObserver {
+public:
+	explicit SearchObserver(Visualizer& visualizer) : vis(visualizer) {
+		// Dictates how many frames to wait inbetween path display
+		pathEvery = vis.desiredFps == 0 ? 240 : vis.desiredFps / 30;
+		pathEvery += vis.frameskip * 5;
+	}
 
-	// Function to color the previous looked at path to already explored color and clear it
-	auto clearPrevious = [&]() {
-		for (int tile : lastPath) {
-			colorQuad(tile, COLORRED);
+	void opened(Tile tile) {
+		if (tile != vis.end) {
+			vis.colorQuad(tile, sf::Color::Green);
 		}
-		lastPath.clear();
-	};
+	}
 
-	// Function to draw current path being looked at in path color
-	auto drawPath = [&]() {
-		while (prevConnect.find(curPath) != prevConnect.end()) {
-			lastPath.push_back(curPath);
-			colorQuad(curPath, COLORBLUE);
-			curPath = prevConnect[curPath];
+	// Color the current path every few frames and mark the tile as explored
+	template <typename ParentOf>
+	void expanded(Tile tile, const ParentOf& parentOf) {
+		if (++frame > pathEvery) {
+			frame = 0;
+			clearPrevious();
+			for (Tile current = tile; parentOf(current) != current; current = parentOf(current)) {
+				lastPath.push_back(current);
+				vis.colorQuad(current, vis.COLORBLUE);
+			}
 		}
-	};
 
-	while (!openHeap.empty()) {
-		int current = std::get<2>(openHeap.top());
-		openHeap.pop();
-		if (closedSet.count(current) == 1) { continue; }
+		if (tile != vis.start) {
+			vis.colorQuad(tile, vis.COLORRED);
+		}
+	}
 
-		closedSet.insert(current);
+	// Keep window responsive, respond to quit, and draw to the screen
+	bool cancelled() {
+		if (vis.checkQuit()) { return true; }
+		vis.draw();
+		return false;
+	}
 
-		// Draw the path that was found and return
-		if (current == end) {
-			clearPrevious();
-			curPath = prevConnect[current];
-			drawPath();
-			return;
+	// Draw the path that was found (without recoloring start and end), or just clear the last shown path
+	void finished(const std::vector<Tile>& path) {
+		clearPrevious();
+		for (std::size_t i = 1; i + 1 < path.size(); ++i) {
+			vis.colorQuad(path[i], vis.COLORBLUE);
 		}
+	}
 
-		// Color the current path and reset it for the future
-		if (++frame > pathEvery) {
-			frame = 0;
-			clearPrevious();
-			curPath = current;
-			drawPath();
+private:
+	// Color the previous looked at path to already explored color and clear it
+	void clearPrevious() {
+		for (Tile tile : lastPath) {
+			vis.colorQuad(tile, vis.COLORRED);
 		}
+		lastPath.clear();
+	}
 
-		if (current != start) {
-			colorQuad(current, COLORRED);
-		}
+	Visualizer& vis;
+	std::vector<Tile> lastPath;
+	int frame = 0;
+	int pathEvery;
+};
 
-		getNeighbors(neighbors, current);
-		for (int neighbor : neighbors) {
-			if (closedSet.count(neighbor) == 1) { continue; }  // Skip already explored nodes
-			float distance = (isDiagonal(current, neighbor)) ? SQRT2 : 1.0f;
-			float newG = gScores[current] + distance;
-			// If this is the first time this node has been seen or if the current
-			// travel cost to it is lower than previously seen, record the new
-			// lowest score, set the prevConnect for this neighbor to current, and add it to the nodes to explore.
-			// (This may add duplicate tile entries, but it is rare and does not break admissibility)
-			if (gScores.find(neighbor) == gScores.end() || newG < gScores[neighbor]) {
-				prevConnect[neighbor] = current;
-				gScores[neighbor] = newG;
-				openHeap.push(node(newG + heuristic(neighbor, end), --accumulator, neighbor));
-				if (neighbor != end) {
-					colorQuad(neighbor, sf::Color::Green);
-				}
-			}
-		}
+// Runs A* on the grid and draws progress simultaneously, choosing the
+// specialized search kernel for the movement and cost settings once up front
+void Visualizer::aStar() {
+	if (moveDiagonal) {
+		useFloatCosts ? runAStar<8, FloatCost>() : runAStar<8, FixedCost>();
+	}
+	else {
+		useFloatCosts ? runAStar<4, FloatCost>() : runAStar<4, FixedCost>();
+	}
+}
 
-		// Keep window responsive, respond to quit, and draw to the screen
-		if (checkQuit()) { return; }
+template <int Connectivity, typename Cost>
+void Visualizer::runAStar() {
+	SearchObserver observer(*this);
+	aStarSearch<Connectivity, Cost>(world, start, end, observer);
+}
+
+// Runs the multithreaded A* and draws only the resulting path, since
+// the worker threads cannot draw their progress as they go.
+// The window stays responsive while it runs and Escape stops it
+void Visualizer::parallelAStar() {
+	if (moveDiagonal) {
+		useFloatCosts ? runParallelAStar<8, FloatCost>() : runParallelAStar<8, FixedCost>();
+	}
+	else {
+		useFloatCosts ? runParallelAStar<4, FloatCost>() : runParallelAStar<4, FixedCost>();
+	}
+}
+
+template <int Connectivity, typename Cost>
+void Visualizer::runParallelAStar() {
+	SearchResult<Cost> result;
+	std::atomic<bool> stop(false);
+	std::atomic<bool> done(false);
+	std::thread search([&]() {
+		result = parallelAStarSearch<Connectivity, Cost>(world, start, end, threadCount, &stop);
+		done.store(true);
+	});
+
+	// Keep window responsive, respond to quit, and draw to the screen.
+	// Camera events only read the world, so they are safe while the search runs.
+	// Sleeping between polls leaves the cores to the workers even when frameskip
+	// or an unlimited framerate means draw() does not wait
+	while (!done.load()) {
+		if (checkQuit()) {
+			stop.store(true);
+			break;
+		}
 		draw();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1000 / 60));
 	}
-	// No path found, so clear the last shown path
-	clearPrevious();
+	search.join();
+	if (stop.load()) { return; }
 
-	return;
+	for (std::size_t i = 1; i + 1 < result.path.size(); ++i) {
+		colorQuad(result.path[i], COLORBLUE);
+	}
+	draw();
 }
@@ -1,57 +1,86 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "World.h"
 #include <random>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
 
 class Visualizer {
 public:
-	Visualizer(int width, int height, int squarePix, int spacing, int fps, int frameskip, bool diagonal);
+	Visualizer(int width, int height, int rows, int cols, int squarePix, int spacing, int fps, int frameskip, bool diagonal, bool floatCosts, int threads);
 
 	void run();
 
 private:
+	class SearchObserver;
+
+	template <int Connectivity, typename Cost>
+	void runAStar();
+	template <int Connectivity, typename Cost>
+	void runParallelAStar();
+
 	void draw();
+	void updateView();
+	void clampView();
+	void panView(float rows, float cols);
+	void zoomView(float factor, int pixelX, int pixelY);
+	bool handleViewEvent(const sf::Event& event);
 	void initMaze();
 	void mazeDepthFirstSearch();
 	void mazeWilsons();
 	void aStar();
+	void parallelAStar();
 	void blankTileVertices();
 	void createStartEnd();
 	void handleClicks(bool leftClick, bool rightClick);
-	void setStart(int tile, bool blockOriginal = false);
-	void setEnd(int tile, bool blockOriginal = false);
-	void setAllTiles(bool blocked = false);
-	void colorQuad(int tile, sf::Color color);
-	void setBlocked(int tile, bool blocked);
-	void getNeighbors(std::vector<int>& neighbors, int tile, bool includeStraight, bool includeDiag, bool blocked = false, int distance = 1);
-	void getNeighbors(std::vector<int>& neighbors, int tile, bool blocked = false);
-	int getHoveredSquare();
-	float heuristic(int from, int to);
+	void setStart(Tile tile, bool blockOriginal = false);
+	void setEnd(Tile tile, bool blockOriginal = false);
+	void colorQuad(Tile tile, sf::Color color);
+	void colorVisibleQuad(int row, int col, sf::Color color);
+	void setBlocked(Tile tile, bool blocked);
+	void getCellNeighbors(std::vector<Tile>& neighbors, Tile tile);
+	std::uint8_t paletteIndex(sf::Color color);
+	Tile getHoveredSquare();
 	bool checkQuit();
-	bool isDiagonal(int from, int to);
-	bool isDiagonal(int rowFrom, int colFrom, int rowTo, int colTo);
-	bool isStraight(int from, int to);
-	bool isStraight(int rowFrom, int colFrom, int rowTo, int colTo);
 
 	const sf::Color COLORGRAY = sf::Color(35, 35, 35, 255);
 	const sf::Color COLORRED = sf::Color(255, 70, 50, 255);
 	const sf::Color COLORBLUE = sf::Color(55, 120, 255, 255);
-	const float SQRT2 = 1.4142135f;
 
-	float moveVal;
+	float tilePix;     // Pixels per tile (including padding) at the current zoom
+	float minTilePix;
+	float maxTilePix;
+	float viewRow;     // Tile coordinates of the top left corner of the window
+	float viewCol;
+	int firstRow;      // Range of tiles currently held in tileVertices
+	int firstCol;
+	int visibleRows;
+	int visibleCols;
 	int rowCount;
 	int colCount;
 	int width;
 	int height;
-	int start;
-	int end;
+	Tile start;
+	Tile end;
 	int tileSpacing;
 	int desiredFps;
 	int frameskip;
 	int frame;
+	int threadCount;
 	bool moveDiagonal;
+	bool useFloatCosts;
+	bool panning;
+	bool viewDirty;    // Camera moved since tileVertices was last built
+	sf::Vector2i panFrom;
 	std::mt19937 rng;
-	std::vector<bool> tiles;
+	World world;
+	// Colors drawn over tiles by the algorithms, stored per world chunk as indices into
+	// palette (0 = no color, so the tile is drawn from its open/blocked state)
+	std::unordered_map<std::size_t, std::vector<std::uint8_t>> overlay;
+	std::vector<sf::Color> palette;
 	sf::VertexArray tileVertices;
 	sf::RenderWindow window;
-};
\ No newline at end of file
+};
@@ -0,0 +1,37 @@
+#include "World.h"
+#include <algorithm>
+
+World::World(int rows, int cols) : rowCount(rows), colCount(cols) {
+	chunkCols = (cols + CHUNKMASK) >> CHUNKSHIFT;
+	int chunkRows = (rows + CHUNKMASK) >> CHUNKSHIFT;
+	chunks.resize(static_cast<std::size_t>(chunkRows) * chunkCols);
+
+	blockedChunk = std::make_shared<Chunk>();
+	std::fill(std::begin(blockedChunk->rows), std::end(blockedChunk->rows), ~std::uint64_t(0));
+}
+
+// Changes a single tile, copying its chunk first if it is missing or shared
+void World::setBlocked(int row, int col, bool blocked) {
+	if (isBlocked(row, col) == blocked) { return; }
+
+	std::shared_ptr<Chunk>& chunk = chunks[chunkOf(row, col)];
+	if (!chunk) {
+		chunk = std::make_shared<Chunk>();
+	}
+	else if (chunk.use_count() > 1) {
+		chunk = std::make_shared<Chunk>(*chunk);
+	}
+
+	std::uint64_t bit = std::uint64_t(1) << (col & CHUNKMASK);
+	if (blocked) {
+		chunk->rows[row & CHUNKMASK] |= bit;
+	}
+	else {
+		chunk->rows[row & CHUNKMASK] &= ~bit;
+	}
+}
+
+// Unblock or block every tile, releasing all allocated chunks
+void World::setAll(bool blocked) {
+	std::fill(chunks.begin(), chunks.end(), blocked ? blockedChunk : nullptr);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Index of a tile in row-major order (wide enough for grids beyond 2^31 tiles)
+typedef std::int64_t Tile;
+
+// Grid of open/blocked tiles stored in square chunks that are allocated lazily.
+// A missing chunk is entirely open and every entirely blocked chunk shares one copy,
+// so memory grows with the number of chunks that have actually been drawn on.
+class World {
+public:
+	static constexpr int CHUNKSHIFT = 6;
+	static constexpr int CHUNKSIZE = 1 << CHUNKSHIFT;  // Tiles along each side of a chunk
+	static constexpr int CHUNKMASK = CHUNKSIZE - 1;
+
+	World(int rows, int cols);
+
+	int rows() const { return rowCount; }
+	int cols() const { return colCount; }
+
+	Tile tileAt(int row, int col) const { return static_cast<Tile>(row) * colCount + col; }
+	int rowOf(Tile tile) const { return static_cast<int>(tile / colCount); }
+	int colOf(Tile tile) const { return static_cast<int>(tile % colCount); }
+
+	// Index of the chunk holding a tile, and of a tile within its chunk
+	std::size_t chunkOf(int row, int col) const { return static_cast<std::size_t>(row >> CHUNKSHIFT) * chunkCols + (col >> CHUNKSHIFT); }
+	static int offsetInChunk(int row, int col) { return ((row & CHUNKMASK) << CHUNKSHIFT) | (col & CHUNKMASK); }
+
+	bool isBlocked(int row, int col) const {
+		const Chunk* chunk = chunks[chunkOf(row, col)].get();
+		return chunk != nullptr && ((chunk->rows[row & CHUNKMASK] >> (col & CHUNKMASK)) & 1) != 0;
+	}
+	bool isBlocked(Tile tile) const { return isBlocked(rowOf(tile), colOf(tile)); }
+
+	void setBlocked(int row, int col, bool blocked);
+	void setBlocked(Tile tile, bool blocked) { setBlocked(rowOf(tile), colOf(tile), blocked); }
+	void setAll(bool blocked);
+
+private:
+	// One bit per tile, one 64 bit word per row
+	struct Chunk {
+		std::uint64_t rows[CHUNKSIZE];
+	};
+	static_assert(CHUNKSIZE == 64, "Chunk rows are stored as 64 bit words");
+
+	int rowCount;
+	int colCount;
+	int chunkCols;
+	std::vector<std::shared_ptr<Chunk>> chunks;  // nullptr = all open
+	std::shared_ptr<Chunk> blockedChunk;         // Shared by every all blocked chunk
+};
@@ -1,23 +1,32 @@
 #include <SFML/Graphics.hpp>
 #include "Visualizer.h"
+#include "Benchmark.h"
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <cstddef>
+#include <thread>
 
 int main(int argc, char* argv[]) {
 	bool diagonal = false;
+	bool floatCosts = false;
+	bool bench = false;
 	int width = 620;
 	int height = 620;
+	int rows = 0;
+	int cols = 0;
 	int tileSize = 19;
 	int fps = 120;
 	int frameskip = 0;
 	int padding = 1;
+	int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
 	std::vector<std::string> arguments(argv + 1, argv + argc);
 
 	// Attempt to parse command line arguments to be used instead of defaults
 	for (std::size_t index = 0; index < arguments.size(); ++index) {
 		if (arguments[index] == "-diagonal") { diagonal = true; }
+		if (arguments[index] == "-float") { floatCosts = true; }
+		if (arguments[index] == "-bench") { bench = true; }
 
 		// Read the argument and its value
 		if (index >= arguments.size() - 1) { continue; }
@@ -30,6 +39,12 @@ int main(int argc, char* argv[]) {
 			else if (current == "-height") {
 				height = std::clamp(std::stoi(next), 400, 1600);
 			}
+			else if (current == "-rows") {
+				rows = std::clamp(std::stoi(next), 2, 100000);
+			}
+			else if (current == "-cols") {
+				cols = std::clamp(std::stoi(next), 2, 100000);
+			}
 			else if (current == "-tile") {
 				tileSize = std::clamp(std::stoi(next), 1, 39);
 			}
@@ -42,11 +57,19 @@ int main(int argc, char* argv[]) {
 			else if (current == "-skip") {
 				frameskip = std::clamp(std::stoi(next), 0, 5000);
 			}
+			else if (current == "-threads") {
+				threads = std::clamp(std::stoi(next), 1, 256);
+			}
 		}
 		catch (...) {}
 	}
 
-	Visualizer visualizer(width, height, tileSize, padding, fps, frameskip, diagonal);
+	// Benchmark without opening a window, on a 3000 x 3000 map unless a size was given
+	if (bench) {
+		return runBenchmark(rows > 0 ? rows : 3000, cols > 0 ? cols : 3000, diagonal, floatCosts, threads);
+	}
+
+	Visualizer visualizer(width, height, rows, cols, tileSize, padding, fps, frameskip, diagonal, floatCosts, threads);
 	visualizer.run();
 
 	return 0;